@@ -6,15 +6,18 @@ import PackageDescription
 let package = Package(
     name: "Dynatrace",
     platforms: [
-        .iOS(.v9), .tvOS(.v11)
+        .iOS(.v12), .tvOS(.v12)
     ],
     products: [
         .library(
             name: "Dynatrace",
-            targets: ["Dynatrace"])
+            targets: ["Dynatrace", "DynatraceSwift"])
     ],
     dependencies: [],
     targets: [
-        .binaryTarget(name: "Dynatrace", path: "Dynatrace.xcframework")
+        .binaryTarget(name: "Dynatrace", path: "Dynatrace.xcframework"),
+        .target(
+            name: "DynatraceSwift",
+            dependencies: ["Dynatrace"])
     ]
 )
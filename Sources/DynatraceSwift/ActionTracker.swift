@@ -0,0 +1,64 @@
+//
+//  ActionTracker.swift
+//  DynatraceSwift
+//
+//  Copyright © 2022 Dynatrace LLC. All rights reserved.
+//
+
+import Foundation
+import Dynatrace
+
+/// Owns the action of a single publisher subscription or sequence iteration.
+///
+/// Start, completion and cancellation can arrive on different threads; the lock makes sure the
+/// action is entered at most once and ended exactly once.
+final class ActionTracker {
+
+    private let name: DTXActionName
+    private let parent: DTXAction?
+    private let lock = NSLock()
+    private var action: DTXAction?
+    private var ended = false
+
+    init(name: DTXActionName, parent: DTXAction?) {
+        self.name = name
+        self.parent = parent
+    }
+
+    deinit {
+        action?.cancel()
+    }
+
+    func start() {
+        lock.lock()
+        defer { lock.unlock() }
+        guard action == nil, !ended else {
+            return
+        }
+        action = enterAction(name, parent: parent)
+    }
+
+    func leave() {
+        take()?.leave()
+    }
+
+    func fail(_ error: Error) {
+        guard let action = take() else {
+            return
+        }
+        endAction(action, name, throwing: error)
+    }
+
+    func cancel() {
+        take()?.cancel()
+    }
+
+    private func take() -> DTXAction? {
+        lock.lock()
+        defer { lock.unlock() }
+        let current = action
+        action = nil
+        ended = true
+        return current
+    }
+}
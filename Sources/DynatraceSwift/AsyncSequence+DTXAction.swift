@@ -0,0 +1,80 @@
+//
+//  AsyncSequence+DTXAction.swift
+//  DynatraceSwift
+//
+//  Copyright © 2022 Dynatrace LLC. All rights reserved.
+//
+
+#if compiler(>=5.5.2) && canImport(_Concurrency)
+import Dynatrace
+
+/// An asynchronous sequence that times each iteration of its base sequence as an action.
+@available(iOS 13.0, tvOS 13.0, *)
+public struct DTXActionSequence<Base: AsyncSequence>: AsyncSequence {
+
+    public typealias Element = Base.Element
+
+    private let base: Base
+    private let name: DTXActionName
+    private let parent: DTXAction?
+
+    init(base: Base, name: DTXActionName, parent: DTXAction?) {
+        self.base = base
+        self.name = name
+        self.parent = parent
+    }
+
+    public struct AsyncIterator: AsyncIteratorProtocol {
+
+        private var base: Base.AsyncIterator
+        private let tracker: ActionTracker
+        private var started = false
+
+        init(base: Base.AsyncIterator, tracker: ActionTracker) {
+            self.base = base
+            self.tracker = tracker
+        }
+
+        public mutating func next() async throws -> Element? {
+            if !started {
+                started = true
+                tracker.start()
+            }
+            do {
+                guard let element = try await base.next() else {
+                    tracker.leave()
+                    return nil
+                }
+                return element
+            } catch {
+                tracker.fail(error)
+                throw error
+            }
+        }
+    }
+
+    public func makeAsyncIterator() -> AsyncIterator {
+        return AsyncIterator(base: base.makeAsyncIterator(),
+                             tracker: ActionTracker(name: name, parent: parent ?? DTXActionContext.current))
+    }
+}
+
+@available(iOS 13.0, tvOS 13.0, *)
+extension AsyncSequence {
+
+    /// Times each iteration of this sequence as an action.
+    ///
+    /// The action is entered when the first element is requested and left when the sequence ends.
+    /// A thrown error is reported on the action before it is left; a `CancellationError` cancels
+    /// the action instead. If iteration stops early, the action is cancelled once the iterator is
+    /// released.
+    ///
+    /// - Parameters:
+    ///   - name: Name of the action.
+    ///   - parent: The parent action. If nil, the action from `DTXActionContext.current` is used.
+    /// - Returns: A sequence that yields the elements of this sequence.
+    public func dtxAction(_ name: DTXActionName, parentAction parent: DTXAction? = nil) -> DTXActionSequence<Self> {
+        return DTXActionSequence(base: self, name: name, parent: parent)
+    }
+}
+#endif
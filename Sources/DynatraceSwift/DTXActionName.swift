@@ -0,0 +1,39 @@
+//
+//  DTXActionName.swift
+//  DynatraceSwift
+//
+//  Copyright © 2022 Dynatrace LLC. All rights reserved.
+//
+
+import Foundation
+
+/// The name of a user action.
+///
+/// The name is kept as a Swift `String` and bridged to `NSString` when it is passed to
+/// `DTXAction.enter(withName:)`, once per entered action. Nothing else is copied or converted on
+/// the way to the agent. Literals and interpolations are both accepted, so
+/// `withAction("Load \(id)") { ... }` works like passing a `String`.
+public struct DTXActionName: Hashable, ExpressibleByStringInterpolation, CustomStringConvertible {
+
+    /// The action name as passed to the agent.
+    public let value: String
+
+    /// Creates an action name from an arbitrary string.
+    public init(_ name: String) {
+        value = name
+    }
+
+    /// Creates an action name from a string literal.
+    public init(stringLiteral literal: String) {
+        value = literal
+    }
+
+    /// Creates an action name from an interpolated string literal.
+    public init(stringInterpolation: DefaultStringInterpolation) {
+        self.init(String(stringInterpolation: stringInterpolation))
+    }
+
+    public var description: String {
+        return value
+    }
+}
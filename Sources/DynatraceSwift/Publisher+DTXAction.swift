@@ -0,0 +1,47 @@
+//
+//  Publisher+DTXAction.swift
+//  DynatraceSwift
+//
+//  Copyright © 2022 Dynatrace LLC. All rights reserved.
+//
+
+#if canImport(Combine)
+import Combine
+import Dynatrace
+
+@available(iOS 13.0, tvOS 13.0, *)
+extension Publisher {
+
+    /// Times each subscription to this publisher as an action.
+    ///
+    /// The action is entered when the subscription starts and left when the publisher finishes.
+    /// A failure is reported on the action before it is left; a cancelled subscription cancels
+    /// the action.
+    ///
+    /// - Parameters:
+    ///   - name: Name of the action.
+    ///   - parent: The parent action. If nil, the action from `DTXActionContext.current` at subscription
+    ///     time is used when available.
+    /// - Returns: A publisher that forwards all events of this publisher.
+    public func dtxAction(_ name: DTXActionName, parentAction parent: DTXAction? = nil) -> Deferred<Publishers.HandleEvents<Self>> {
+        return Deferred {
+            #if compiler(>=5.5.2) && canImport(_Concurrency)
+            let tracker = ActionTracker(name: name, parent: parent ?? DTXActionContext.current)
+            #else
+            let tracker = ActionTracker(name: name, parent: parent)
+            #endif
+            return self.handleEvents(
+                receiveSubscription: { _ in tracker.start() },
+                receiveCompletion: { completion in
+                    switch completion {
+                    case .finished:
+                        tracker.leave()
+                    case .failure(let error):
+                        tracker.fail(error)
+                    }
+                },
+                receiveCancel: { tracker.cancel() })
+        }
+    }
+}
+#endif
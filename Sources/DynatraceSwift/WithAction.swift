@@ -0,0 +1,165 @@
+//
+//  WithAction.swift
+//  DynatraceSwift
+//
+//  Copyright © 2022 Dynatrace LLC. All rights reserved.
+//
+
+import Foundation
+import os
+@_exported import Dynatrace
+
+#if compiler(>=5.5.2) && canImport(_Concurrency)
+/// Holds the action that encloses the currently running task.
+@available(iOS 13.0, tvOS 13.0, *)
+public enum DTXActionContext {
+
+    @TaskLocal static var scope: ActionScope?
+
+    /// The innermost action entered with `withAction` in the current task, or nil.
+    ///
+    /// Child tasks created inside `withAction` inherit the value, so actions entered there become
+    /// child actions without passing the parent by hand. Unstructured tasks inherit it as well but
+    /// may outlive the action; once `withAction` returns, they see nil here and start root actions.
+    public static var current: DTXAction? {
+        return scope?.activeAction
+    }
+}
+
+/// State of an `ActionScope`, stored in the header of its buffer.
+struct ActionScopeState {
+    let action: DTXAction
+    var finished: Bool
+}
+
+/// An action bound to a task by `withAction`, marked finished before the action is left.
+///
+/// The state and its `os_unfair_lock` share one allocation; the lock lives in the buffer's element
+/// storage so its address stays stable. It is `@unchecked Sendable` because `finished` is only read
+/// and written while holding that lock, and the `DTXAction` reference itself never changes.
+@available(iOS 13.0, tvOS 13.0, *)
+final class ActionScope: ManagedBuffer<ActionScopeState, os_unfair_lock>, @unchecked Sendable {
+
+    static func make(_ action: DTXAction) -> ActionScope {
+        let buffer = create(minimumCapacity: 1) { _ in
+            ActionScopeState(action: action, finished: false)
+        }
+        let scope = unsafeDowncast(buffer, to: ActionScope.self)
+        scope.withUnsafeMutablePointerToElements { $0.initialize(to: os_unfair_lock()) }
+        return scope
+    }
+
+    var activeAction: DTXAction? {
+        return withUnsafeMutablePointers { state, lock in
+            os_unfair_lock_lock(lock)
+            defer { os_unfair_lock_unlock(lock) }
+            return state.pointee.finished ? nil : state.pointee.action
+        }
+    }
+
+    func finish() {
+        withUnsafeMutablePointers { state, lock in
+            os_unfair_lock_lock(lock)
+            state.pointee.finished = true
+            os_unfair_lock_unlock(lock)
+        }
+    }
+}
+#endif
+
+/// Enters an action, runs `body` and leaves the action afterwards.
+///
+/// If `body` throws, the error is reported on the action before it is left; a `CancellationError`
+/// cancels the action instead. When the agent is not capturing, no action is created and `body`
+/// runs without further overhead.
+///
+/// - Parameters:
+///   - name: Name of the action.
+///   - parent: The parent action. If nil, the action from `DTXActionContext.current` is used when available.
+///   - body: The code to time.
+/// - Returns: The value returned by `body`.
+@discardableResult
+public func withAction<T>(_ name: DTXActionName, parentAction parent: DTXAction? = nil, _ body: () throws -> T) rethrows -> T {
+    #if compiler(>=5.5.2) && canImport(_Concurrency)
+    if #available(iOS 13.0, tvOS 13.0, *) {
+        guard let action = enterAction(name, parent: parent ?? DTXActionContext.current) else {
+            return try body()
+        }
+        let scope = ActionScope.make(action)
+        return try finishAction(action, name) {
+            defer { scope.finish() }
+            return try DTXActionContext.$scope.withValue(scope, operation: body)
+        }
+    }
+    #endif
+    guard let action = enterAction(name, parent: parent) else {
+        return try body()
+    }
+    return try finishAction(action, name, body)
+}
+
+#if compiler(>=5.5.2) && canImport(_Concurrency)
+/// Enters an action, awaits `body` and leaves the action afterwards.
+///
+/// The action is available from `DTXActionContext.current` while `body` runs. If `body` throws, the
+/// error is reported on the action before it is left; if the task is cancelled with a
+/// `CancellationError`, the action is cancelled instead.
+///
+/// - Parameters:
+///   - name: Name of the action.
+///   - parent: The parent action. If nil, the action from `DTXActionContext.current` is used.
+///   - body: The code to time.
+/// - Returns: The value returned by `body`.
+@available(iOS 13.0, tvOS 13.0, *)
+@discardableResult
+public func withAction<T>(_ name: DTXActionName, parentAction parent: DTXAction? = nil, _ body: () async throws -> T) async rethrows -> T {
+    guard let action = enterAction(name, parent: parent ?? DTXActionContext.current) else {
+        return try await body()
+    }
+    let scope = ActionScope.make(action)
+    do {
+        let result = try await DTXActionContext.$scope.withValue(scope) { () async throws -> T in
+            defer { scope.finish() }
+            return try await body()
+        }
+        action.leave()
+        return result
+    } catch {
+        endAction(action, name, throwing: error)
+        throw error
+    }
+}
+#endif
+
+@inline(__always)
+func enterAction(_ name: DTXActionName, parent: DTXAction?) -> DTXAction? {
+    guard let parent = parent else {
+        return DTXAction.enter(withName: name.value)
+    }
+    return DTXAction.enter(withName: name.value, parentAction: parent)
+}
+
+/// Ends an action whose timed code threw. Task cancellation cancels the action, any other error
+/// is reported on it before it is left.
+func endAction(_ action: DTXAction, _ name: DTXActionName, throwing error: Error) {
+    #if compiler(>=5.5.2) && canImport(_Concurrency)
+    if #available(iOS 13.0, tvOS 13.0, *), error is CancellationError {
+        action.cancel()
+        return
+    }
+    #endif
+    action.reportError(withName: name.value, error: error as NSError)
+    action.leave()
+}
+
+@inline(__always)
+private func finishAction<T>(_ action: DTXAction, _ name: DTXActionName, _ body: () throws -> T) rethrows -> T {
+    do {
+        let result = try body()
+        action.leave()
+        return result
+    } catch {
+        endAction(action, name, throwing: error)
+        throw error
+    }
+}